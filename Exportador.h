@@ -0,0 +1,387 @@
+/**
+ * @file Exportador.h
+ * @brief Define el escritor en flujo para exportar los historiales de los sensores.
+ * @project Sistema IoT de Monitoreo Polimórfico
+ */
+
+#ifndef EXPORTADOR_H
+#define EXPORTADOR_H
+
+#include "ListaSensor.h"
+#include <cstdio>   // snprintf, perror
+#include <cstdlib>  // strtof
+#include <cstring>
+#include <cmath>    // std::isfinite
+#include <cerrno>
+#include <stdint.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+/**
+ * @enum FormatoExportacion
+ * @brief Formatos de archivo soportados por EscritorExportacion.
+ */
+enum FormatoExportacion {
+    /** @brief Texto con columnas tipo,id,valor (una lectura por línea; el ID va entre comillas si hace falta). */
+    EXPORTAR_CSV,
+    /**
+     * @brief Binario columnar: cabecera "SIOT" + versión (uint32), y por sensor
+     * tipo (1 byte), largo del ID (uint16), ID, cantidad (uint64) y la columna
+     * de valores de 4 bytes (float o int32). Enteros en el orden de bytes nativo.
+     */
+    EXPORTAR_BINARIO
+};
+
+/**
+ * @class EscritorExportacion
+ * @brief Escribe los historiales en un archivo a través de un búfer fijo de 1 MiB.
+ * * La memoria usada no depende del tamaño del historial: las lecturas se formatean
+ * directamente en el búfer y este se vacía con write() al llenarse. Los números se
+ * formatean a mano con aritmética entera para que la exportación quede limitada por
+ * la E/S; los float se escriben con la representación más corta que se lee de vuelta
+ * al mismo valor, de modo que el CSV conserva exactamente los datos del binario.
+ */
+class EscritorExportacion {
+private:
+    static const size_t TAM_BUFFER = 1 << 20;
+
+    int fd;
+    char* buffer;
+    size_t usado;
+    FormatoExportacion formato;
+    /** @brief Se activa ante el primer error de escritura; las siguientes se ignoran. */
+    bool error;
+
+    /** @brief Escribe el contenido del búfer en el archivo y lo deja vacío. */
+    void vaciar() {
+        size_t hecho = 0;
+        while (!error && hecho < usado) {
+            ssize_t n = ::write(fd, buffer + hecho, usado - hecho);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                perror("No se pudo escribir el archivo de exportacion");
+                error = true;
+            } else {
+                hecho += static_cast<size_t>(n);
+            }
+        }
+        usado = 0;
+    }
+
+    /** @brief Garantiza 'n' bytes libres en el búfer (n <= TAM_BUFFER). */
+    void reservar(size_t n) {
+        if (usado + n > TAM_BUFFER) vaciar();
+    }
+
+    void agregarBytes(const void* datos, size_t n) {
+        reservar(n);
+        std::memcpy(buffer + usado, datos, n);
+        usado += n;
+    }
+
+    /**
+     * @brief Escribe 'n' en decimal terminando justo antes de 'fin', de dos en dos dígitos.
+     * @return Número de dígitos escritos.
+     */
+    static int escribirDigitos(uint64_t n, char* fin) {
+        static const char PARES[] =
+            "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+            "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+            "8081828384858687888990919293949596979899";
+        char* p = fin;
+        while (n >= 100) {
+            unsigned r = static_cast<unsigned>(n % 100);
+            n /= 100;
+            p -= 2;
+            std::memcpy(p, PARES + 2 * r, 2);
+        }
+        if (n >= 10) {
+            p -= 2;
+            std::memcpy(p, PARES + 2 * n, 2);
+        } else {
+            *--p = static_cast<char>('0' + n);
+        }
+        return static_cast<int>(fin - p);
+    }
+
+    void agregarEntero(long long v) {
+        char tmp[24];
+        uint64_t u = v < 0 ? 0ULL - static_cast<uint64_t>(v) : static_cast<uint64_t>(v);
+        int i = static_cast<int>(sizeof(tmp)) - escribirDigitos(u, tmp + sizeof(tmp));
+        if (v < 0) tmp[--i] = '-';
+        agregarBytes(tmp + i, sizeof(tmp) - i);
+    }
+
+    /**
+     * @brief Formatea con el menor número de dígitos que vuelve a leerse como el mismo float.
+     * * Para 1e-5 <= |v| < 1e15 sigue el esquema de Ryu sin tablas: los extremos del
+     * intervalo de redondeo de v se calculan como enteros exactos de 64 bits y se
+     * eliminan dígitos mientras el intervalo lo permita, una sola pasada sin tanteos
+     * ni aritmética de punto flotante. Los demás valores recurren a snprintf.
+     */
+    void agregarFlotante(float v) {
+        static const uint64_t POT5[] = {1ULL, 5ULL, 25ULL, 125ULL, 625ULL, 3125ULL, 15625ULL,
+                                        78125ULL, 390625ULL, 1953125ULL, 9765625ULL,
+                                        48828125ULL, 244140625ULL, 1220703125ULL,
+                                        6103515625ULL, 30517578125ULL};
+        float a = v < 0 ? -v : v;
+        if (!std::isfinite(v) || a < 1e-5f || a >= 1e15f) {
+            agregarFlotanteExtremo(v);
+            return;
+        }
+
+        uint32_t bits;
+        std::memcpy(&bits, &v, sizeof(bits));
+        uint32_t fraccion = bits & 0x7FFFFFu;
+        int expIeee = static_cast<int>((bits >> 23) & 0xFFu);
+
+        // v = mv * 2^e2 y el intervalo que se lee como v es (mm, mp) * 2^e2,
+        // cerrado si la mantisa es par (redondeo al par al leer)
+        uint64_t m2 = fraccion | (1u << 23);
+        int e2 = expIeee - 127 - 23 - 2;
+        bool aceptaLimites = (m2 & 1u) == 0;
+        uint64_t mv = 4 * m2;
+        uint64_t mp = mv + 2;
+        uint64_t mm = mv - (fraccion != 0 || expIeee <= 1 ? 2 : 1);
+
+        // Escala a enteros decimales: valor = vr * 10^e10, con marcas de resto exacto
+        uint64_t vr, vp, vm;
+        int e10 = 0;
+        bool vrCeros = true;
+        bool vmCeros = aceptaLimites;
+        if (e2 >= 0) {
+            vr = mv << e2;
+            vp = mp << e2;
+            vm = mm << e2;
+            if (!aceptaLimites) vp--;
+        } else {
+            // x * 2^-s = x * 5^s / 10^s; se descartan de entrada j dígitos que el
+            // intervalo (ancho >= 3 * 5^s) deja eliminar siempre
+            int s = -e2;
+            int j = static_cast<int>((static_cast<uint64_t>(s) * 732923u) >> 20) - 2; // floor(s*log10(5)) - 2
+            if (j < 0) j = 0;
+            uint64_t xv = mv * POT5[s - j];
+            uint64_t xp = mp * POT5[s - j];
+            uint64_t xm = mm * POT5[s - j];
+            uint64_t resto = (1ULL << j) - 1;
+            vr = xv >> j;
+            vp = xp >> j;
+            vm = xm >> j;
+            e10 = j - s;
+            vrCeros = (xv & resto) == 0;
+            vmCeros = aceptaLimites && (xm & resto) == 0;
+            if (!aceptaLimites && (xp & resto) == 0) vp--;
+        }
+
+        int quitados = 0;
+        unsigned ultimo = 0;
+        uint64_t n;
+        if (!vrCeros && !vmCeros) {
+            // Caso común: ningún resto exacto que vigilar, se quitan dígitos de dos en dos
+            while (vp / 100 > vm / 100) {
+                ultimo = static_cast<unsigned>(vr % 100) / 10;
+                vr /= 100;
+                vp /= 100;
+                vm /= 100;
+                quitados += 2;
+            }
+            if (vp / 10 > vm / 10) {
+                ultimo = static_cast<unsigned>(vr % 10);
+                vr /= 10;
+                vp /= 10;
+                vm /= 10;
+                quitados++;
+            }
+            n = vr + ((vr == vm || ultimo >= 5) ? 1 : 0);
+        } else {
+            while (vp / 10 > vm / 10) {
+                vmCeros = vmCeros && vm % 10 == 0;
+                vrCeros = vrCeros && ultimo == 0;
+                ultimo = static_cast<unsigned>(vr % 10);
+                vr /= 10;
+                vp /= 10;
+                vm /= 10;
+                quitados++;
+            }
+            if (vmCeros) {
+                // El límite inferior es alcanzable: se pueden quitar sus ceros finales
+                while (vm != 0 && vm % 10 == 0) {
+                    vrCeros = vrCeros && ultimo == 0;
+                    ultimo = static_cast<unsigned>(vr % 10);
+                    vr /= 10;
+                    vp /= 10;
+                    vm /= 10;
+                    quitados++;
+                }
+            }
+            if (vrCeros && ultimo == 5 && vr % 2 == 0) ultimo = 4; // empate exacto: al par
+            n = vr + (((vr == vm && (!aceptaLimites || !vmCeros)) || ultimo >= 5) ? 1 : 0);
+        }
+        int k = -(e10 + quitados); // decimales de n
+        while (n % 10 == 0) {
+            n /= 10;
+            k--;
+        }
+
+        // n tiene a lo sumo 10 dígitos y |k| <= 14: caben en 32 bytes con signo y "0."
+        static const uint64_t POT10[] = {1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL,
+                                         1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL};
+        int d = 1;
+        while (d < 10 && n >= POT10[d]) d++;
+        reservar(32);
+        char* out = buffer + usado;
+        if (v < 0) *out++ = '-';
+        if (k <= 0) {
+            escribirDigitos(n, out + d);
+            out += d;
+            for (int i = 0; i < -k; i++) *out++ = '0';
+        } else if (d > k) {
+            escribirDigitos(n / POT10[k], out + (d - k));
+            out += d - k;
+            *out++ = '.';
+            for (int i = 0; i < k; i++) out[i] = '0';
+            escribirDigitos(n % POT10[k], out + k);
+            out += k;
+        } else {
+            *out++ = '0';
+            *out++ = '.';
+            for (int i = 0; i < k - d; i++) *out++ = '0';
+            escribirDigitos(n, out + d);
+            out += d;
+        }
+        usado = static_cast<size_t>(out - buffer);
+    }
+
+    /** @brief Formato de respaldo para ceros, valores no finitos, muy pequeños o muy grandes. */
+    void agregarFlotanteExtremo(float v) {
+        char tmp[32];
+        int n = 0;
+        if (!std::isfinite(v)) {
+            n = std::snprintf(tmp, sizeof(tmp), "%g", v);
+        } else {
+            for (int p = 1; p <= 9; p++) {
+                n = std::snprintf(tmp, sizeof(tmp), "%.*g", p, v);
+                if (std::strtof(tmp, nullptr) == v) break;
+            }
+        }
+        agregarBytes(tmp, static_cast<size_t>(n));
+    }
+
+    /**
+     * @brief Copia un ID como campo CSV, entre comillas si contiene ',', '"' o saltos de línea.
+     * @param id ID del sensor.
+     * @param largo Largo del ID.
+     * @param destino Búfer de al menos 2 * largo + 2 bytes.
+     * @return Bytes escritos en 'destino'.
+     */
+    static size_t campoCsv(const char* id, size_t largo, char* destino) {
+        if (std::strcspn(id, ",\"\r\n") >= largo) {
+            std::memcpy(destino, id, largo);
+            return largo;
+        }
+        size_t n = 0;
+        destino[n++] = '"';
+        for (size_t i = 0; i < largo; i++) {
+            if (id[i] == '"') destino[n++] = '"';
+            destino[n++] = id[i];
+        }
+        destino[n++] = '"';
+        return n;
+    }
+
+    void agregarValor(int v) { agregarEntero(v); }
+    void agregarValor(float v) { agregarFlotante(v); }
+
+    void agregarBinario(int v) {
+        int32_t x = static_cast<int32_t>(v);
+        agregarBytes(&x, sizeof(x));
+    }
+    void agregarBinario(float v) { agregarBytes(&v, sizeof(v)); }
+
+public:
+    /** @brief Constructor. Reserva el búfer; el archivo se abre con abrir(). */
+    EscritorExportacion(FormatoExportacion f)
+        : fd(-1), buffer(new char[TAM_BUFFER]), usado(0), formato(f), error(false) {}
+
+    /** @brief Destructor. Vacía el búfer pendiente, cierra el archivo y libera el búfer. */
+    ~EscritorExportacion() {
+        cerrar();
+        delete[] buffer;
+    }
+
+    EscritorExportacion(const EscritorExportacion& other) = delete;
+    EscritorExportacion& operator=(const EscritorExportacion& other) = delete;
+
+    /**
+     * @brief Crea (o trunca) el archivo de salida y escribe la cabecera del formato.
+     * @param ruta Ruta del archivo.
+     * @return true si el archivo se abrió, false en caso contrario.
+     */
+    bool abrir(const char* ruta) {
+        cerrar();
+        fd = ::open(ruta, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            perror("No se pudo abrir el archivo de exportacion");
+            return false;
+        }
+        error = false;
+        if (formato == EXPORTAR_CSV) {
+            agregarBytes("tipo,id,valor\n", 14);
+        } else {
+            uint32_t version = 1;
+            agregarBytes("SIOT", 4);
+            agregarBytes(&version, sizeof(version));
+        }
+        return true;
+    }
+
+    /**
+     * @brief Vacía el búfer y cierra el archivo.
+     * @return true si todas las escrituras tuvieron éxito.
+     */
+    bool cerrar() {
+        if (fd < 0) return !error;
+        vaciar();
+        if (::close(fd) != 0) error = true;
+        fd = -1;
+        return !error;
+    }
+
+    /**
+     * @brief Escribe el historial completo de un sensor.
+     * @tparam T Tipo de dato de las lecturas (int o float).
+     * @param tipo Letra del tipo de sensor ('T' o 'P').
+     * @param id ID del sensor.
+     * @param historial Lista de lecturas a exportar.
+     */
+    template <typename T>
+    void serie(char tipo, const char* id, const ListaSensor<T>& historial) {
+        if (fd < 0 || error) return;
+        size_t largoId = std::strlen(id);
+        if (formato == EXPORTAR_CSV) {
+            char* campo = new char[2 * largoId + 2];
+            size_t largoCampo = campoCsv(id, largoId, campo);
+            historial.recorrer([&](const T& v) {
+                reservar(largoCampo + 40);
+                buffer[usado++] = tipo;
+                buffer[usado++] = ',';
+                std::memcpy(buffer + usado, campo, largoCampo);
+                usado += largoCampo;
+                buffer[usado++] = ',';
+                agregarValor(v);
+                buffer[usado++] = '\n';
+            });
+            delete[] campo;
+        } else {
+            uint16_t largo = static_cast<uint16_t>(largoId);
+            uint64_t cantidad = static_cast<uint64_t>(historial.tamano());
+            agregarBytes(&tipo, 1);
+            agregarBytes(&largo, sizeof(largo));
+            agregarBytes(id, largoId);
+            agregarBytes(&cantidad, sizeof(cantidad));
+            historial.recorrer([&](const T& v) { agregarBinario(v); });
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,259 @@
+/**
+ * @file HistorialRollup.h
+ * @brief Implementa niveles de agregación (rollup) para el historial de largo plazo.
+ * @project Sistema IoT de Monitoreo Polimórfico
+ */
+
+#ifndef HISTORIAL_ROLLUP_H
+#define HISTORIAL_ROLLUP_H
+
+#include "ListaSensor.h"
+#include <ctime> // time
+#include <climits> // LLONG_MIN
+
+/**
+ * @struct CubetaRollup
+ * @brief Agregado (mínimo, máximo, suma y cuenta) de las lecturas de un intervalo de tiempo.
+ * @tparam T Tipo de dato de las lecturas.
+ */
+template <typename T>
+struct CubetaRollup {
+    /** @brief Inicio del intervalo en segundos Unix, alineado a la anchura del nivel. */
+    long long inicio;
+    ResumenLS<T> agregado;
+};
+
+/**
+ * @class NivelRollup
+ * @brief Arreglo circular de cubetas de anchura fija, indexado por el inicio de cada cubeta.
+ * * La cubeta que empieza en 't' vive en la posición (t / anchura) % maxCubetas, así que
+ * registrar una lectura es O(1) y una consulta solo visita las cubetas de su rango.
+ * Conserva las 'maxCubetas' cubetas más recientes; las más antiguas se sobrescriben.
+ * El arreglo se reserva con la primera lectura.
+ * @tparam T Tipo de dato de las lecturas.
+ */
+template <typename T>
+class NivelRollup {
+private:
+    CubetaRollup<T>* cubetas;
+    /** @brief Anchura de cada cubeta en segundos. */
+    long long anchura;
+    long long maxCubetas;
+    /** @brief Inicio de la cubeta más reciente (LLONG_MIN si aún no hay lecturas). */
+    long long ultimoInicio;
+    /** @brief Inicio de la primera cubeta registrada. */
+    long long primerInicio;
+
+    /** @brief Posición del arreglo que corresponde a una cubeta. */
+    CubetaRollup<T>& ranura(long long inicio) const {
+        return cubetas[(inicio / anchura) % maxCubetas];
+    }
+
+    /** @brief Inicio de la cubeta más antigua que aún puede estar en el arreglo. */
+    long long primeroRetenido() const {
+        return ultimoInicio - (maxCubetas - 1) * anchura;
+    }
+public:
+    /**
+     * @brief Constructor.
+     * @param anchuraSeg Anchura de cada cubeta en segundos (ej. 60 para 1 minuto).
+     * @param maxCub Número máximo de cubetas a conservar.
+     */
+    NivelRollup(long long anchuraSeg, long long maxCub)
+        : cubetas(nullptr), anchura(anchuraSeg), maxCubetas(maxCub),
+          ultimoInicio(LLONG_MIN), primerInicio(LLONG_MIN) {}
+
+    /** @brief Destructor. Libera el arreglo de cubetas. */
+    ~NivelRollup() {
+        delete[] cubetas;
+    }
+
+    NivelRollup(const NivelRollup& other) = delete;
+    NivelRollup& operator=(const NivelRollup& other) = delete;
+
+    /** @brief Anchura de cada cubeta en segundos. */
+    long long getAnchura() const { return anchura; }
+
+    /** @brief Segundos de historia que el nivel puede cubrir como máximo. */
+    long long cobertura() const { return anchura * maxCubetas; }
+
+    /**
+     * @brief Instante desde el cual el nivel conserva todas las lecturas recibidas.
+     * @return LLONG_MIN si nunca se ha descartado ninguna cubeta.
+     */
+    long long retenidoDesde() const {
+        if (ultimoInicio == LLONG_MIN || primerInicio >= primeroRetenido()) return LLONG_MIN;
+        return primeroRetenido();
+    }
+
+    /**
+     * @brief Redondea un instante hacia arriba al inicio de cubeta más cercano.
+     * @param t Instante en segundos Unix.
+     * @return El menor inicio de cubeta que es >= t.
+     */
+    long long alinearArriba(long long t) const {
+        long long r = t - t % anchura;
+        return r < t ? r + anchura : r;
+    }
+
+    /**
+     * @brief Acumula una lectura en la cubeta que corresponde a su instante.
+     * * Si el reloj retrocede, la lectura se acumula en la cubeta más reciente.
+     * @param valor Lectura a acumular.
+     * @param t Instante de la lectura en segundos Unix.
+     */
+    void registrar(const T& valor, long long t) {
+        long long inicio = t - t % anchura;
+        if (!cubetas) {
+            cubetas = new CubetaRollup<T>[maxCubetas];
+            for (long long i = 0; i < maxCubetas; i++) cubetas[i].inicio = LLONG_MIN;
+            primerInicio = inicio;
+        }
+        if (inicio < ultimoInicio) inicio = ultimoInicio;
+
+        CubetaRollup<T>& c = ranura(inicio);
+        if (c.inicio != inicio) {
+            // Abre la cubeta; lo que hubiera en la posición tiene una vuelta o más de antigüedad
+            c.inicio = inicio;
+            c.agregado.cuenta = 0;
+            c.agregado.suma = 0.0;
+            c.agregado.minimo = valor;
+            c.agregado.maximo = valor;
+        }
+        ultimoInicio = inicio;
+
+        ResumenLS<T>& a = c.agregado;
+        if (valor < a.minimo) a.minimo = valor;
+        if (a.maximo < valor) a.maximo = valor;
+        a.suma += valor;
+        a.cuenta++;
+    }
+
+    /**
+     * @brief Combina las cubetas cuyo inicio cae en [desde, hasta).
+     * * Recorre de la más reciente a la más antigua y solo dentro del rango pedido.
+     * @param desde Primer inicio de cubeta a incluir, en segundos Unix.
+     * @param hasta Fin exclusivo para el inicio de cubeta.
+     * @param acc Resumen acumulado; se actualiza con las cubetas encontradas.
+     */
+    void acumularRango(long long desde, long long hasta, ResumenLS<T>& acc) const {
+        if (ultimoInicio == LLONG_MIN) return;
+        long long t = alinearArriba(hasta) - anchura;
+        if (t > ultimoInicio) t = ultimoInicio;
+        if (desde < primeroRetenido()) desde = primeroRetenido();
+        for (; t >= desde; t -= anchura) {
+            const CubetaRollup<T>& c = ranura(t);
+            if (c.inicio != t) continue; // sin lecturas en ese intervalo
+            const ResumenLS<T>& a = c.agregado;
+            if (acc.cuenta == 0 || a.minimo < acc.minimo) acc.minimo = a.minimo;
+            if (acc.cuenta == 0 || acc.maximo < a.maximo) acc.maximo = a.maximo;
+            acc.suma += a.suma;
+            acc.cuenta += a.cuenta;
+        }
+    }
+};
+
+/**
+ * @class HistorialRollup
+ * @brief Mantiene de forma incremental los niveles de 1 minuto y 1 hora de un sensor.
+ * * Cada lectura actualiza la cubeta vigente de ambos niveles en O(1). Las consultas
+ * de una hora o más leen cubetas de hora y solo completan el borde con cubetas de
+ * minuto, así que su costo depende del tamaño de la ventana y no del número de
+ * lecturas ni de lo retenido. Las cubetas se sobrescriben al envejecer sin
+ * sincronización: tanto registrar() como consultar() deben llamarse desde el hilo
+ * de ingesta.
+ * @tparam T Tipo de dato de las lecturas.
+ */
+template <typename T>
+class HistorialRollup {
+private:
+    /** @brief Cubetas de 1 minuto; conserva 1 día más la cubeta en curso. */
+    NivelRollup<T> minutos;
+    /** @brief Cubetas de 1 hora; conserva 90 días más la cubeta en curso. */
+    NivelRollup<T> horas;
+public:
+    /** @brief Constructor. Crea los niveles vacíos. */
+    HistorialRollup() : minutos(60, 24 * 60 + 1), horas(3600, 24 * 90 + 1) {}
+
+    /**
+     * @brief Registra una lectura con la hora actual del sistema.
+     * @param valor Lectura a registrar.
+     */
+    void registrar(const T& valor) {
+        registrar(valor, static_cast<long long>(std::time(nullptr)));
+    }
+
+    /**
+     * @brief Registra una lectura en un instante dado.
+     * @param valor Lectura a registrar.
+     * @param t Instante de la lectura en segundos Unix.
+     */
+    void registrar(const T& valor, long long t) {
+        minutos.registrar(valor, t);
+        horas.registrar(valor, t);
+    }
+
+    /**
+     * @brief Resume las lecturas de los últimos 'segundos' respecto a la hora actual.
+     * @param segundos Tamaño de la ventana de consulta.
+     * @param inicioCubierto Si no es nullptr, recibe el instante desde el que se contaron lecturas.
+     * @return Agregado de la ventana. cuenta es 0 si no hay lecturas.
+     */
+    ResumenLS<T> consultar(long long segundos, long long* inicioCubierto = nullptr) const {
+        return consultar(segundos, static_cast<long long>(std::time(nullptr)), inicioCubierto);
+    }
+
+    /**
+     * @brief Resume las lecturas de la ventana (ahora - segundos, ahora].
+     * * Solo se cuentan cubetas completas dentro de la ventana, por lo que el borde
+     * inicial se redondea hacia arriba al siguiente minuto; la cubeta de minuto que
+     * contiene 'ahora' se cuenta completa. Las ventanas de menos de una hora usan
+     * solo el nivel de minutos; las demás suman las horas completas y resuelven
+     * ambos bordes con minutos cuando aún se conservan (1 día); si no, el borde
+     * inicial se redondea a la siguiente hora. Si la ventana excede lo retenido, el
+     * resultado empieza más tarde: 'inicioCubierto' indica dónde.
+     * @param segundos Tamaño de la ventana de consulta.
+     * @param ahora Fin de la ventana en segundos Unix.
+     * @param inicioCubierto Si no es nullptr, recibe el instante desde el que se contaron lecturas.
+     * @return Agregado de la ventana. cuenta es 0 si no hay lecturas.
+     */
+    ResumenLS<T> consultar(long long segundos, long long ahora, long long* inicioCubierto = nullptr) const {
+        ResumenLS<T> r;
+        r.cuenta = 0;
+        r.suma = 0.0;
+        r.minimo = static_cast<T>(0);
+        r.maximo = static_cast<T>(0);
+
+        long long desde = ahora - segundos + 1; // primer segundo dentro de la ventana
+        long long cubierto = desde;
+        if (segundos <= 0) {
+            cubierto = ahora + 1;
+        } else if (segundos < horas.getAnchura()) {
+            cubierto = minutos.alinearArriba(desde);
+            if (cubierto < minutos.retenidoDesde()) cubierto = minutos.retenidoDesde();
+            minutos.acumularRango(cubierto, ahora + 1, r);
+        } else {
+            long long primeraHora = horas.alinearArriba(desde);
+            long long ultimaHora = horas.alinearArriba(ahora + 1) - horas.getAnchura();
+            // La hora que contiene 'ahora' se resuelve con minutos si aún se conservan
+            long long finHoras = ultimaHora >= minutos.retenidoDesde() ? ultimaHora : ahora + 1;
+            cubierto = primeraHora;
+            if (cubierto < horas.retenidoDesde()) cubierto = horas.retenidoDesde();
+            horas.acumularRango(cubierto, finHoras, r);
+            if (finHoras == ultimaHora) minutos.acumularRango(ultimaHora, ahora + 1, r);
+            if (cubierto == primeraHora) {
+                // Borde anterior a la primera hora completa, con minutos si se conservan
+                long long borde = minutos.alinearArriba(desde);
+                if (borde < minutos.retenidoDesde()) borde = minutos.retenidoDesde();
+                if (borde < primeraHora) {
+                    minutos.acumularRango(borde, primeraHora, r);
+                    cubierto = borde;
+                }
+            }
+        }
+        if (inicioCubierto) *inicioCubierto = cubierto;
+        return r;
+    }
+};
+
+#endif
@@ -8,17 +8,21 @@
 #define LISTA_GESTION_H
 
 #include "SensorBase.h"
+#include "Exportador.h"
 #include <iostream>
 #include <cstring>
+#include <atomic>
 
 /**
  * @struct NodoGestion
  * @brief Nodo para la ListaGestion. Almacena un puntero polimórfico a SensorBase.
+ * * El enlace 'sig' es atómico: un nodo se publica una sola vez (de nullptr a
+ * su sucesor) y nunca se desenlaza mientras la lista está viva.
  */
 struct NodoGestion {
     /** @brief Puntero polimórfico que puede apuntar a SensorTemperatura o SensorPresion. */
     SensorBase* sensor;
-    NodoGestion* sig;
+    std::atomic<NodoGestion*> sig;
     /** @brief Constructor del nodo de gestión. */
     NodoGestion(SensorBase* s) : sensor(s), sig(nullptr) {}
 };
@@ -27,61 +31,135 @@ struct NodoGestion {
  * @class ListaGestion
  * @brief Colección principal que administra todos los objetos SensorBase.
  * * Implementa las funciones de búsqueda y la ejecución polimórfica de la lógica de procesamiento.
+ * * Es segura para varios hilos de ingesta: la inserción es lock-free (CAS sobre
+ * el 'sig' del último nodo) y la búsqueda no toma candados ni reintenta. Como la
+ * lista solo crece, ningún nodo se libera mientras otro hilo puede leerlo; la
+ * memoria se recupera únicamente en el destructor, que exige que ya no haya
+ * hilos usando la lista.
  */
 class ListaGestion {
 private:
     /** @brief Puntero al primer nodo de la lista. */
-    NodoGestion* cabeza;
+    std::atomic<NodoGestion*> cabeza;
+    /** @brief Pista del último nodo; puede ir atrasada, nunca adelantada. */
+    std::atomic<NodoGestion*> cola;
+
+    /**
+     * @brief Enlaza 'nuevo' al final de la lista partiendo de la pista de cola.
+     * @param nuevo Nodo ya construido a publicar.
+     */
+    void enlazarFinal(NodoGestion* nuevo) {
+        NodoGestion* esperado = nullptr;
+        if (cabeza.compare_exchange_strong(esperado, nuevo, std::memory_order_acq_rel)) {
+            cola.store(nuevo, std::memory_order_release);
+            return;
+        }
+        NodoGestion* tmp = cola.load(std::memory_order_acquire);
+        if (!tmp) tmp = esperado; // la cabeza ya existe pero la pista aún no se actualiza
+        while (true) {
+            NodoGestion* sig = tmp->sig.load(std::memory_order_acquire);
+            if (sig) {
+                tmp = sig;
+                continue;
+            }
+            if (tmp->sig.compare_exchange_weak(sig, nuevo, std::memory_order_acq_rel)) {
+                break;
+            }
+        }
+        avanzarCola(nuevo);
+    }
+
+    /**
+     * @brief Adelanta la pista de cola hasta 'nodo' si sigue apuntando a uno anterior.
+     * @param nodo Último nodo conocido por el hilo que llama.
+     */
+    void avanzarCola(NodoGestion* nodo) {
+        NodoGestion* actual = cola.load(std::memory_order_acquire);
+        while (actual != nodo && nodo->sig.load(std::memory_order_acquire) == nullptr) {
+            if (cola.compare_exchange_weak(actual, nodo, std::memory_order_acq_rel)) return;
+        }
+    }
 public:
     /** @brief Constructor. Inicializa la lista vacía. */
-    ListaGestion() : cabeza(nullptr) {}
+    ListaGestion() : cabeza(nullptr), cola(nullptr) {}
+
+    ListaGestion(const ListaGestion& other) = delete;
+    ListaGestion& operator=(const ListaGestion& other) = delete;
 
     /**
      * @brief Destructor. Libera toda la memoria dinámica.
      * * Llama a 'delete borr->sensor', activando el destructor virtual para liberar
      * la memoria de cada objeto SensorBase y, a su vez, la de sus ListasSensor internas.
+     * * Debe ejecutarse cuando ningún otro hilo accede ya a la lista.
      */
     ~ListaGestion() {
-        NodoGestion* tmp = cabeza;
+        NodoGestion* tmp = cabeza.load(std::memory_order_acquire);
         while (tmp) {
             NodoGestion* borr = tmp;
-            tmp = tmp->sig;
+            tmp = tmp->sig.load(std::memory_order_relaxed);
             if (borr->sensor) {
                 std::cout << "[Destructor General] Liberando Nodo: " << borr->sensor->getNombre() << "\n";
                 delete borr->sensor; // Llama al destructor virtual correcto
             }
             delete borr;
         }
-        cabeza = nullptr;
+        cabeza.store(nullptr, std::memory_order_relaxed);
+        cola.store(nullptr, std::memory_order_relaxed);
     }
 
     /**
-     * @brief Inserta un nuevo sensor al final de la lista.
+     * @brief Inserta un nuevo sensor al final de la lista (lock-free).
      * @param s Puntero al objeto SensorBase (ej. SensorTemperatura* o SensorPresion*).
      */
     void insertar(SensorBase* s) {
+        enlazarFinal(new NodoGestion(s));
+    }
+
+    /**
+     * @brief Inserta un sensor solo si no existe otro con el mismo ID (lock-free).
+     * * Recorre la lista comparando nombres y publica el nodo con CAS en el último
+     * enlace; si otro hilo gana la carrera, continúa revisando los nodos recién
+     * añadidos, de modo que dos hilos nunca registran el mismo ID.
+     * @param s Sensor candidato. Si ya existía uno con su ID, la lista no lo adopta
+     * y el llamador conserva la propiedad de 's'.
+     * @return El sensor registrado con ese ID (el existente o 's').
+     */
+    SensorBase* insertarUnico(SensorBase* s) {
         NodoGestion* nuevo = new NodoGestion(s);
-        if (!cabeza) {
-            cabeza = nuevo;
-            return;
+        NodoGestion* esperado = nullptr;
+        if (cabeza.compare_exchange_strong(esperado, nuevo, std::memory_order_acq_rel)) {
+            cola.store(nuevo, std::memory_order_release);
+            return s;
+        }
+        NodoGestion* tmp = esperado;
+        while (true) {
+            if (std::strcmp(tmp->sensor->getNombre(), s->getNombre()) == 0) {
+                delete nuevo;
+                return tmp->sensor;
+            }
+            NodoGestion* sig = tmp->sig.load(std::memory_order_acquire);
+            if (!sig && tmp->sig.compare_exchange_strong(sig, nuevo, std::memory_order_acq_rel)) {
+                avanzarCola(nuevo);
+                return s;
+            }
+            tmp = sig; // el CAS falló: 'sig' trae el nodo que otro hilo acaba de enlazar
         }
-        NodoGestion* tmp = cabeza;
-        while (tmp->sig) tmp = tmp->sig;
-        tmp->sig = nuevo;
     }
 
     /**
      * @brief Busca un sensor por su ID (nombre).
+     * * No toma candados ni reintenta: recorre los nodos publicados hasta el
+     * momento, por lo que puede ejecutarse en paralelo con insertar().
      * @param nom ID (nombre) del sensor a buscar.
      * @return Puntero a SensorBase* si lo encuentra, nullptr si no.
      */
-    SensorBase* buscarPorNombre(const char* nom) {
-        NodoGestion* tmp = cabeza;
+    SensorBase* buscarPorNombre(const char* nom) const {
+        NodoGestion* tmp = cabeza.load(std::memory_order_acquire);
         while (tmp) {
             if (std::strcmp(tmp->sensor->getNombre(), nom) == 0) {
                 return tmp->sensor;
             }
-            tmp = tmp->sig;
+            tmp = tmp->sig.load(std::memory_order_acquire);
         }
         return nullptr;
     }
@@ -92,10 +170,10 @@ public:
      */
     void procesarTodos() {
         std::cout << "--- Ejecutando Polimorfismo ---\n";
-        NodoGestion* tmp = cabeza;
+        NodoGestion* tmp = cabeza.load(std::memory_order_acquire);
         while (tmp) {
             tmp->sensor->procesarLectura(); // Se llama a la función correcta de cada subclase
-            tmp = tmp->sig;
+            tmp = tmp->sig.load(std::memory_order_acquire);
         }
     }
 
@@ -104,15 +182,37 @@ public:
      */
     void imprimir() const {
         std::cout << "[Lista de Gestion]\n";
-        NodoGestion* tmp = cabeza;
+        NodoGestion* tmp = cabeza.load(std::memory_order_acquire);
         if (!tmp) {
             std::cout << "Lista de gestion vacia.\n";
             return;
         }
         while (tmp) {
             tmp->sensor->imprimirInfo();
-            tmp = tmp->sig;
+            tmp = tmp->sig.load(std::memory_order_acquire);
+        }
+    }
+
+    /**
+     * @brief Exporta los historiales de todos los sensores a un archivo.
+     * * La memoria usada es constante: las lecturas se escriben en flujo a través
+     * del búfer de EscritorExportacion.
+     * * Recorre los nodos del historial de cada sensor, así que no debe ejecutarse
+     * mientras otro hilo ingresa lecturas: eliminarMenor() y la retención de
+     * lecturas crudas liberan nodos. Detenga la ingesta o llame desde su hilo.
+     * @param ruta Ruta del archivo de salida.
+     * @param formato EXPORTAR_CSV o EXPORTAR_BINARIO.
+     * @return true si el archivo se escribió completo, false si hubo algún error.
+     */
+    bool exportar(const char* ruta, FormatoExportacion formato) const {
+        EscritorExportacion escritor(formato);
+        if (!escritor.abrir(ruta)) return false;
+        NodoGestion* tmp = cabeza.load(std::memory_order_acquire);
+        while (tmp) {
+            tmp->sensor->exportar(escritor);
+            tmp = tmp->sig.load(std::memory_order_acquire);
         }
+        return escritor.cerrar();
     }
 };
 
@@ -9,6 +9,7 @@
 
 #include <iostream>
 #include <limits> // Para numeric_limits
+#include <atomic>
 
 /**
  * @struct NodoLS
@@ -23,9 +24,33 @@ struct NodoLS {
     NodoLS(const T& d) : dato(d), sig(nullptr) {}
 };
 
+/**
+ * @struct ResumenLS
+ * @brief Agregados del historial leídos de forma consistente por resumen().
+ * @tparam T Tipo de dato de las lecturas.
+ */
+template <typename T>
+struct ResumenLS {
+    long long cuenta;
+    double suma;
+    T minimo;
+    T maximo;
+
+    /** @brief Promedio de las lecturas resumidas. Devuelve 0 si no hay lecturas. */
+    T promedio() const {
+        if (cuenta == 0) return static_cast<T>(0);
+        return static_cast<T>(suma / cuenta);
+    }
+};
+
 /**
  * @class ListaSensor
  * @brief Lista enlazada simple y genérica (template) que almacena el historial de lecturas.
+ * * Modo un escritor / varios lectores: el hilo de ingesta es el único que llama a
+ * insertarFinal(), eliminarMenor() y limpiar(); cualquier otro hilo puede llamar a
+ * resumen() en paralelo. El escritor publica cuenta, suma, mínimo y máximo con un
+ * contador de secuencia (estilo seqlock), sin candados en la ruta de escritura;
+ * el lector reintenta si la copia coincidió con una escritura.
  * @tparam T Tipo de dato a almacenar.
  */
 template <typename T>
@@ -33,9 +58,32 @@ class ListaSensor {
 private:
     /** @brief Puntero al primer nodo de la lista. */
     NodoLS<T>* cabeza;
+    /** @brief Puntero al último nodo, para insertar al final en O(1). */
+    NodoLS<T>* cola;
+    /** @brief Máximo de lecturas crudas a conservar (0 = sin límite). */
+    long long retencion;
+
+    /** @brief Contador de secuencia: impar mientras el escritor actualiza los agregados. */
+    std::atomic<unsigned> secuencia;
+    std::atomic<long long> cuenta;
+    std::atomic<double> suma;
+    std::atomic<T> minimo;
+    std::atomic<T> maximo;
+
+    /** @brief Marca el inicio de una actualización de los agregados publicados. */
+    void abrirEscritura() {
+        secuencia.store(secuencia.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    /** @brief Publica los agregados actualizados a los lectores. */
+    void cerrarEscritura() {
+        secuencia.store(secuencia.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
 public:
     /** @brief Constructor. Inicializa la lista vacía. */
-    ListaSensor() : cabeza(nullptr) {}
+    ListaSensor() : cabeza(nullptr), cola(nullptr), retencion(0), secuencia(0), cuenta(0), suma(0.0),
+                    minimo(static_cast<T>(0)), maximo(static_cast<T>(0)) {}
 
     /** @brief Destructor. Llama a limpiar() para liberar todos los nodos. */
     ~ListaSensor() {
@@ -52,13 +100,123 @@ public:
      */
     void insertarFinal(const T& valor) {
         NodoLS<T>* nuevo = new NodoLS<T>(valor);
+        long long c = cuenta.load(std::memory_order_relaxed);
+
+        abrirEscritura();
         if (!cabeza) {
             cabeza = nuevo;
-            return;
+        } else {
+            cola->sig = nuevo;
+        }
+        cola = nuevo;
+        if (c == 0 || valor < minimo.load(std::memory_order_relaxed)) {
+            minimo.store(valor, std::memory_order_relaxed);
+        }
+        if (c == 0 || maximo.load(std::memory_order_relaxed) < valor) {
+            maximo.store(valor, std::memory_order_relaxed);
+        }
+        suma.store(suma.load(std::memory_order_relaxed) + valor, std::memory_order_relaxed);
+        cuenta.store(c + 1, std::memory_order_relaxed);
+        cerrarEscritura();
+
+        if (retencion > 0 && c + 1 > retencion) {
+            // Recorta en bloque para amortizar el recálculo de los agregados
+            recortarInicio(c + 1 - (retencion - retencion / 4));
+        }
+    }
+
+    /**
+     * @brief Fija la política de envejecimiento de lecturas crudas.
+     * * Al superar el límite se descartan las lecturas más antiguas hasta dejar
+     * 3/4 del límite, de modo que la lista conserva entre 3/4 y la totalidad
+     * de 'maxLecturas'. Los resúmenes de largo plazo deben venir de un
+     * HistorialRollup alimentado en paralelo.
+     * @param maxLecturas Máximo de lecturas a conservar; 0 desactiva el límite.
+     */
+    void fijarRetencion(long long maxLecturas) {
+        retencion = maxLecturas < 0 ? 0 : maxLecturas;
+    }
+
+    /**
+     * @brief Recorre las lecturas en orden de inserción sin copiarlas.
+     * * Como eliminarMenor(), recorre los nodos, así que se usa desde el hilo escritor.
+     * @tparam F Función o functor con firma void(const T&).
+     * @param f Se invoca una vez por cada lectura.
+     */
+    template <typename F>
+    void recorrer(F f) const {
+        for (NodoLS<T>* tmp = cabeza; tmp; tmp = tmp->sig) {
+            f(tmp->dato);
+        }
+    }
+
+    /**
+     * @brief Número de lecturas almacenadas actualmente.
+     * @return Cantidad de nodos de la lista.
+     */
+    long long tamano() const {
+        return cuenta.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Elimina las 'n' lecturas más antiguas y recalcula los agregados en una pasada.
+     * @param n Número de nodos a eliminar desde la cabeza.
+     */
+    void recortarInicio(long long n) {
+        NodoLS<T>* viejos = cabeza;
+        NodoLS<T>* ultimoViejo = nullptr;
+        NodoLS<T>* nuevaCabeza = cabeza;
+        for (long long i = 0; i < n && nuevaCabeza; i++) {
+            ultimoViejo = nuevaCabeza;
+            nuevaCabeza = nuevaCabeza->sig;
+        }
+        if (!ultimoViejo) return;
+
+        long long c = 0;
+        double s = 0.0;
+        T mn = static_cast<T>(0);
+        T mx = static_cast<T>(0);
+        for (NodoLS<T>* tmp = nuevaCabeza; tmp; tmp = tmp->sig) {
+            if (c == 0 || tmp->dato < mn) mn = tmp->dato;
+            if (c == 0 || mx < tmp->dato) mx = tmp->dato;
+            s += tmp->dato;
+            c++;
+        }
+
+        abrirEscritura();
+        cabeza = nuevaCabeza;
+        if (!cabeza) cola = nullptr;
+        cuenta.store(c, std::memory_order_relaxed);
+        suma.store(s, std::memory_order_relaxed);
+        minimo.store(mn, std::memory_order_relaxed);
+        maximo.store(mx, std::memory_order_relaxed);
+        cerrarEscritura();
+
+        ultimoViejo->sig = nullptr;
+        while (viejos) {
+            NodoLS<T>* borr = viejos;
+            viejos = viejos->sig;
+            delete borr;
+        }
+    }
+
+    /**
+     * @brief Obtiene cuenta, suma, mínimo y máximo del historial como una sola foto.
+     * * Seguro de llamar desde hilos lectores mientras el escritor sigue insertando.
+     * @return Agregados coherentes entre sí del historial publicado.
+     */
+    ResumenLS<T> resumen() const {
+        ResumenLS<T> r;
+        while (true) {
+            unsigned s1 = secuencia.load(std::memory_order_acquire);
+            if (s1 & 1u) continue; // escritura en curso
+            r.cuenta = cuenta.load(std::memory_order_relaxed);
+            r.suma = suma.load(std::memory_order_relaxed);
+            r.minimo = minimo.load(std::memory_order_relaxed);
+            r.maximo = maximo.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (secuencia.load(std::memory_order_relaxed) == s1) return r;
         }
-        NodoLS<T>* tmp = cabeza;
-        while (tmp->sig) tmp = tmp->sig;
-        tmp->sig = nuevo;
     }
 
     /**
@@ -97,27 +255,37 @@ public:
 
         NodoLS<T>* menor = cabeza;
         NodoLS<T>* antMenor = nullptr;
+        // Segundo menor: será el nuevo mínimo publicado tras eliminar 'menor'
+        NodoLS<T>* segundo = nullptr;
 
         NodoLS<T>* ant = nullptr;
         NodoLS<T>* cur = cabeza;
         
         while (cur) {
             if (cur->dato < menor->dato) {
+                segundo = menor;
                 menor = cur;
                 antMenor = ant;
+            } else if (cur != menor && (!segundo || cur->dato < segundo->dato)) {
+                segundo = cur;
             }
             ant = cur;
             cur = cur->sig;
         }
 
+        abrirEscritura();
         if (antMenor == nullptr) {
             // el menor es la cabeza
             cabeza = cabeza->sig;
-            delete menor;
         } else {
             antMenor->sig = menor->sig;
-            delete menor;
+            if (cola == menor) cola = antMenor;
         }
+        suma.store(suma.load(std::memory_order_relaxed) - menor->dato, std::memory_order_relaxed);
+        cuenta.store(cuenta.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+        minimo.store(segundo->dato, std::memory_order_relaxed);
+        cerrarEscritura();
+        delete menor;
     }
 
     /**
@@ -130,7 +298,14 @@ public:
             tmp = tmp->sig;
             delete borr;
         }
+        abrirEscritura();
         cabeza = nullptr;
+        cola = nullptr;
+        cuenta.store(0, std::memory_order_relaxed);
+        suma.store(0.0, std::memory_order_relaxed);
+        minimo.store(static_cast<T>(0), std::memory_order_relaxed);
+        maximo.store(static_cast<T>(0), std::memory_order_relaxed);
+        cerrarEscritura();
     }
 };
 
@@ -12,6 +12,8 @@
 #include <iostream>
 #include <cstring>
 
+class EscritorExportacion;
+
 /**
  * @class SensorBase
  * @brief Clase abstracta (contrato) para todos los sensores.
@@ -62,6 +64,13 @@ public:
      * @brief Método virtual puro para mostrar la información básica del sensor.
      */
     virtual void imprimirInfo() const = 0; 
+
+    /**
+     * @brief Método virtual puro para volcar el historial completo del sensor.
+     * Recorre los nodos del historial: se llama desde el hilo de ingesta o con la ingesta detenida.
+     * @param escritor Escritor (CSV o binario) que recibe las lecturas.
+     */
+    virtual void exportar(EscritorExportacion& escritor) const = 0;
 };
 
 #endif
\ No newline at end of file
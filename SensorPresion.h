@@ -9,6 +9,8 @@
 
 #include "SensorBase.h"
 #include "ListaSensor.h"
+#include "HistorialRollup.h"
+#include "Exportador.h"
 #include <cstdlib> // atoi
 
 /**
@@ -20,12 +22,17 @@ class SensorPresion : public SensorBase {
 private:
     /** @brief Lista enlazada que almacena el historial de lecturas (int). */
     ListaSensor<int> historial;
+    /** @brief Niveles de 1 minuto y 1 hora para consultas de largo plazo. */
+    HistorialRollup<int> rollup;
 public:
     /**
      * @brief Constructor. Llama al constructor de SensorBase.
      * @param nom ID del sensor.
+     * @param maxCrudas Máximo de lecturas crudas a conservar (0 = sin límite).
      */
-    SensorPresion(const char* nom) : SensorBase(nom) {}
+    SensorPresion(const char* nom, long long maxCrudas = 0) : SensorBase(nom) {
+        historial.fijarRetencion(maxCrudas);
+    }
 
     /** @brief Destructor. */
     virtual ~SensorPresion() {}
@@ -37,6 +44,7 @@ public:
     void agregarLecturaDesdeTexto(const char* valorTxt) override {
         int v = atoi(valorTxt);
         historial.insertarFinal(v);
+        rollup.registrar(v);
         std::cout << "[Log] Insertando Nodo<int> en " << nombre << ": " << v << "\n";
     }
 
@@ -54,6 +62,39 @@ public:
         std::cout << "   Promedio de lecturas: " << prom << "\n";
     }
 
+    /**
+     * @brief Agregados actuales del historial de presiones.
+     * * Puede llamarse desde un hilo de consulta mientras otro hilo ingresa lecturas.
+     * @return Cuenta, suma, mínimo y máximo publicados del historial.
+     */
+    ResumenLS<int> resumenHistorial() const {
+        return historial.resumen();
+    }
+
+    /**
+     * @brief Resume las presiones de los últimos 'segundos' a partir de los niveles de rollup.
+     * * Solo desde el hilo de ingesta: a diferencia de resumenHistorial(), lee cubetas
+     * que la ingesta sobrescribe al envejecer. La ventana se alinea a minutos (a horas
+     * para ventanas de más de un día) y está limitada a los 90 días retenidos; una
+     * ventana de menos de un minuto no contiene cubetas completas y queda vacía.
+     * @param segundos Tamaño de la ventana (ej. 86400 para un día).
+     * @param inicioCubierto Si no es nullptr, recibe el instante desde el que se contaron
+     * lecturas; es posterior al inicio pedido si la ventana excede lo retenido.
+     * @return Cuenta, suma, mínimo y máximo de la ventana. Si cuenta es 0 no hubo
+     * lecturas y los demás campos no son significativos.
+     */
+    ResumenLS<int> resumenUltimos(long long segundos, long long* inicioCubierto = nullptr) const {
+        return rollup.consultar(segundos, inicioCubierto);
+    }
+
+    /**
+     * @brief Vuelca todas las lecturas del historial al escritor.
+     * @param escritor Escritor (CSV o binario) que recibe las lecturas.
+     */
+    void exportar(EscritorExportacion& escritor) const override {
+        escritor.serie('P', nombre, historial);
+    }
+
     /** @brief Muestra el tipo y el ID del sensor. */
     void imprimirInfo() const override {
         std::cout << "[SensorPresion] ID=" << nombre << "\n";
@@ -9,6 +9,8 @@
 
 #include "SensorBase.h"
 #include "ListaSensor.h"
+#include "HistorialRollup.h"
+#include "Exportador.h"
 #include <cstdlib> // atof
 
 /**
@@ -21,12 +23,17 @@ class SensorTemperatura : public SensorBase {
 private:
     /** @brief Lista enlazada que almacena el historial de lecturas (float). */
     ListaSensor<float> historial;
+    /** @brief Niveles de 1 minuto y 1 hora para consultas de largo plazo. */
+    HistorialRollup<float> rollup;
 public:
     /**
      * @brief Constructor. Llama al constructor de SensorBase.
      * @param nom ID del sensor.
+     * @param maxCrudas Máximo de lecturas crudas a conservar (0 = sin límite).
      */
-    SensorTemperatura(const char* nom) : SensorBase(nom) {}
+    SensorTemperatura(const char* nom, long long maxCrudas = 0) : SensorBase(nom) {
+        historial.fijarRetencion(maxCrudas);
+    }
 
     /** @brief Destructor. */
     virtual ~SensorTemperatura() {}
@@ -39,6 +46,7 @@ public:
         // Convierte el texto a float (punto flotante)
         float v = static_cast<float>(atof(valorTxt));
         historial.insertarFinal(v);
+        rollup.registrar(v);
         std::cout << "[Log] Insertando Nodo<float> en " << nombre << ": " << v << "\n";
     }
 
@@ -58,6 +66,39 @@ public:
         std::cout << "   Promedio después de eliminar menor: " << prom << "\n";
     }
 
+    /**
+     * @brief Agregados actuales del historial de temperaturas.
+     * * Puede llamarse desde un hilo de consulta mientras otro hilo ingresa lecturas.
+     * @return Cuenta, suma, mínimo y máximo publicados del historial.
+     */
+    ResumenLS<float> resumenHistorial() const {
+        return historial.resumen();
+    }
+
+    /**
+     * @brief Resume las temperaturas de los últimos 'segundos' a partir de los niveles de rollup.
+     * * Solo desde el hilo de ingesta: a diferencia de resumenHistorial(), lee cubetas
+     * que la ingesta sobrescribe al envejecer. La ventana se alinea a minutos (a horas
+     * para ventanas de más de un día) y está limitada a los 90 días retenidos; una
+     * ventana de menos de un minuto no contiene cubetas completas y queda vacía.
+     * @param segundos Tamaño de la ventana (ej. 86400 para un día).
+     * @param inicioCubierto Si no es nullptr, recibe el instante desde el que se contaron
+     * lecturas; es posterior al inicio pedido si la ventana excede lo retenido.
+     * @return Cuenta, suma, mínimo y máximo de la ventana. Si cuenta es 0 no hubo
+     * lecturas y los demás campos no son significativos.
+     */
+    ResumenLS<float> resumenUltimos(long long segundos, long long* inicioCubierto = nullptr) const {
+        return rollup.consultar(segundos, inicioCubierto);
+    }
+
+    /**
+     * @brief Vuelca todas las lecturas del historial al escritor.
+     * @param escritor Escritor (CSV o binario) que recibe las lecturas.
+     */
+    void exportar(EscritorExportacion& escritor) const override {
+        escritor.serie('T', nombre, historial);
+    }
+
     /** @brief Muestra el tipo y el ID del sensor. */
     void imprimirInfo() const override {
         std::cout << "[SensorTemperatura] ID=" << nombre << "\n";
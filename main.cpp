@@ -122,7 +122,8 @@ void mostrarMenu() {
     cout << "4. Listar Instrumentos Registrados\n";
     cout << "5. Leer 1 Trama de la UART/COM\n";
     cout << "6. Monitoreo Continuo (Ciclo de recepcion)\n";
-    cout << "7. Salir del Sistema\n";
+    cout << "7. Exportar Historiales (CSV/Binario)\n";
+    cout << "8. Salir del Sistema\n";
     cout << "Elige opcion: ";
 }
 
@@ -267,7 +268,21 @@ int main() {
                 }
             }
         }
-        else if (op == 7) {
+        else if (op == 7) { // Exportar Historiales
+            char formato;
+            char ruta[256];
+            cout << "Formato (C=CSV, B=Binario): ";
+            cin >> formato;
+            cout << "Archivo de salida: ";
+            cin >> ruta;
+            FormatoExportacion f = (formato == 'B' || formato == 'b') ? EXPORTAR_BINARIO : EXPORTAR_CSV;
+            if (lista.exportar(ruta, f)) {
+                cout << "[Log] Historiales exportados a '" << ruta << "'.\n";
+            } else {
+                cout << "[Error] No se pudo completar la exportacion.\n";
+            }
+        }
+        else if (op == 8) {
             salir = true;
         }
         else {
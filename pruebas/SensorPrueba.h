@@ -0,0 +1,40 @@
+/**
+ * @file SensorPrueba.h
+ * @brief Sensor mínimo usado por las pruebas de estrés y los benchmarks de ListaGestion.
+ * @project Sistema IoT de Monitoreo Polimórfico
+ */
+
+#ifndef SENSOR_PRUEBA_H
+#define SENSOR_PRUEBA_H
+
+#include "SensorBase.h"
+#include <atomic>
+
+/**
+ * @class SensorPrueba
+ * @brief Sensor sin historial que cuenta cuántas veces lo visita procesarTodos().
+ */
+class SensorPrueba : public SensorBase {
+private:
+    std::atomic<int> visitas;
+public:
+    /**
+     * @brief Constructor.
+     * @param nom ID del sensor.
+     */
+    SensorPrueba(const char* nom) : SensorBase(nom), visitas(0) {}
+
+    /** @brief Número de veces que procesarLectura() se ejecutó sobre este sensor. */
+    int getVisitas() const { return visitas.load(); }
+
+    void agregarLecturaDesdeTexto(const char*) override {}
+
+    /** @brief Registra una visita; permite contar en qué nodos aparece el sensor. */
+    void procesarLectura() override { visitas++; }
+
+    void imprimirInfo() const override {}
+
+    void exportar(EscritorExportacion&) const override {}
+};
+
+#endif
@@ -0,0 +1,96 @@
+/**
+ * @file bench_lista_gestion.cpp
+ * @brief Mide la escalabilidad de ListaGestion de 1 a 32 hilos.
+ * @project Sistema IoT de Monitoreo Polimórfico
+ *
+ * Compilar desde la raíz del repositorio:
+ *   g++ -std=c++11 -O2 -pthread -I. pruebas/bench_lista_gestion.cpp -o bench
+ * Uso: ./bench [inserciones_por_hilo] [busquedas_por_hilo] [sensores_precargados]
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+
+#include "ListaGestion.h"
+#include "SensorPrueba.h"
+
+using namespace std;
+
+/**
+ * @brief Ejecuta 'hilos' trabajadores a la vez y devuelve los segundos transcurridos.
+ * @param hilos Número de hilos.
+ * @param trabajo Función que recibe el índice del hilo.
+ */
+template <typename F>
+double cronometrar(int hilos, F trabajo) {
+    vector<thread> trabajadores;
+    chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+    for (int t = 0; t < hilos; t++) trabajadores.push_back(thread(trabajo, t));
+    for (size_t i = 0; i < trabajadores.size(); i++) trabajadores[i].join();
+    return chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+}
+
+/** @brief Inserciones concurrentes con insertar(): todas compiten por la cola. */
+double medirInsercion(int hilos, int porHilo) {
+    ListaGestion* lista = new ListaGestion();
+    double seg = cronometrar(hilos, [&](int t) {
+        char id[50];
+        for (int i = 0; i < porHilo; i++) {
+            std::snprintf(id, sizeof(id), "I-%d-%d", t, i);
+            lista->insertar(new SensorPrueba(id));
+        }
+    });
+    streambuf* original = cout.rdbuf(nullptr);
+    delete lista;
+    cout.rdbuf(original);
+    return seg;
+}
+
+/** @brief Búsquedas concurrentes de IDs aleatorios sobre una lista precargada. */
+double medirBusqueda(int hilos, int porHilo, int precargados) {
+    ListaGestion* lista = new ListaGestion();
+    char id[50];
+    for (int i = 0; i < precargados; i++) {
+        std::snprintf(id, sizeof(id), "B-%d", i);
+        lista->insertar(new SensorPrueba(id));
+    }
+    atomic<int> encontrados(0);
+    double seg = cronometrar(hilos, [&](int t) {
+        char buscado[50];
+        unsigned semilla = 12345u + static_cast<unsigned>(t);
+        int locales = 0;
+        for (int i = 0; i < porHilo; i++) {
+            semilla = semilla * 1103515245u + 12345u;
+            std::snprintf(buscado, sizeof(buscado), "B-%u", (semilla >> 8) % static_cast<unsigned>(precargados));
+            if (lista->buscarPorNombre(buscado)) locales++;
+        }
+        encontrados += locales;
+    });
+    streambuf* original = cout.rdbuf(nullptr);
+    delete lista;
+    cout.rdbuf(original);
+    if (encontrados.load() != hilos * porHilo) cerr << "[Aviso] busquedas fallidas\n";
+    return seg;
+}
+
+int main(int argc, char** argv) {
+    int inserciones = argc > 1 ? atoi(argv[1]) : 2000;
+    int busquedas = argc > 2 ? atoi(argv[2]) : 20000;
+    int precargados = argc > 3 ? atoi(argv[3]) : 256;
+
+    cout << "hilos  inserciones/s  busquedas/s\n";
+    for (int hilos = 1; hilos <= 32; hilos *= 2) {
+        double tIns = medirInsercion(hilos, inserciones);
+        double tBus = medirBusqueda(hilos, busquedas, precargados);
+        cout << setw(5) << hilos
+             << setw(15) << static_cast<long long>(hilos * static_cast<double>(inserciones) / tIns)
+             << setw(13) << static_cast<long long>(hilos * static_cast<double>(busquedas) / tBus) << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,126 @@
+/**
+ * @file estres_lista_gestion.cpp
+ * @brief Prueba de estrés de la inserción y búsqueda concurrentes de ListaGestion.
+ * @project Sistema IoT de Monitoreo Polimórfico
+ *
+ * Compilar desde la raíz del repositorio:
+ *   g++ -std=c++11 -O1 -g -pthread -fsanitize=thread -I. pruebas/estres_lista_gestion.cpp -o estres
+ * Uso: ./estres [hilos] [ids_por_hilo] [rondas]
+ */
+
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+
+#include "ListaGestion.h"
+#include "SensorPrueba.h"
+
+using namespace std;
+
+static int fallas = 0;
+
+/** @brief Registra una falla sin abortar, para reportar todas las de la ronda. */
+#define VERIFICAR(cond, ...)                         \
+    do {                                             \
+        if (!(cond)) {                               \
+            std::fprintf(stderr, "[FALLA] " __VA_ARGS__); \
+            std::fprintf(stderr, "\n");              \
+            fallas++;                                \
+        }                                            \
+    } while (0)
+
+/**
+ * @brief Ejecuta una ronda: N hilos compiten por registrar los mismos IDs compartidos
+ * con insertarUnico(), insertan IDs propios con insertar() y los buscan al instante.
+ * Al final cada ID debe aparecer exactamente una vez en la lista.
+ */
+void ronda(int hilos, int idsPorHilo) {
+    // Los sensores que pierden la carrera siguen vivos para verificar que la lista no los adoptó
+    vector<vector<SensorPrueba*> > perdedores(hilos);
+    vector<vector<SensorPrueba*> > ganadores(hilos);
+    vector<SensorPrueba*> propios;
+    vector<int> fallasBusqueda(hilos, 0);
+
+    ListaGestion* lista = new ListaGestion();
+    vector<thread> trabajadores;
+    for (int t = 0; t < hilos; t++) {
+        trabajadores.push_back(thread([&, t]() {
+            char id[50];
+            for (int i = 0; i < idsPorHilo; i++) {
+                // Cada hilo recorre los IDs compartidos en distinto orden para forzar choques
+                int k = (i + t * 7) % idsPorHilo;
+                std::snprintf(id, sizeof(id), "C-%d", k);
+                SensorPrueba* s = new SensorPrueba(id);
+                if (lista->insertarUnico(s) == s) {
+                    ganadores[t].push_back(s);
+                } else {
+                    perdedores[t].push_back(s);
+                }
+
+                std::snprintf(id, sizeof(id), "U-%d-%d", t, i);
+                lista->insertar(new SensorPrueba(id));
+                if (!lista->buscarPorNombre(id)) fallasBusqueda[t]++;
+
+                std::snprintf(id, sizeof(id), "C-%d", k);
+                if (!lista->buscarPorNombre(id)) fallasBusqueda[t]++;
+            }
+        }));
+    }
+    for (size_t i = 0; i < trabajadores.size(); i++) trabajadores[i].join();
+
+    int totalGanadores = 0;
+    for (int t = 0; t < hilos; t++) {
+        VERIFICAR(fallasBusqueda[t] == 0, "hilo %d no encontro %d IDs recien insertados", t, fallasBusqueda[t]);
+        totalGanadores += static_cast<int>(ganadores[t].size());
+    }
+    VERIFICAR(totalGanadores == idsPorHilo, "%d ganadores para %d IDs compartidos", totalGanadores, idsPorHilo);
+
+    // Un recorrido completo: cada nodo enlazado suma una visita a su sensor
+    streambuf* original = cout.rdbuf(nullptr);
+    lista->procesarTodos();
+    cout.rdbuf(original);
+
+    char id[50];
+    for (int t = 0; t < hilos; t++) {
+        for (size_t i = 0; i < ganadores[t].size(); i++) {
+            VERIFICAR(ganadores[t][i]->getVisitas() == 1, "%s aparece %d veces",
+                      ganadores[t][i]->getNombre(), ganadores[t][i]->getVisitas());
+        }
+        for (size_t i = 0; i < perdedores[t].size(); i++) {
+            VERIFICAR(perdedores[t][i]->getVisitas() == 0, "%s duplicado en la lista",
+                      perdedores[t][i]->getNombre());
+        }
+        for (int i = 0; i < idsPorHilo; i++) {
+            std::snprintf(id, sizeof(id), "U-%d-%d", t, i);
+            SensorPrueba* s = static_cast<SensorPrueba*>(lista->buscarPorNombre(id));
+            VERIFICAR(s && s->getVisitas() == 1, "%s aparece %d veces", id, s ? s->getVisitas() : 0);
+        }
+    }
+
+    original = cout.rdbuf(nullptr);
+    delete lista; // libera ganadores y sensores propios
+    cout.rdbuf(original);
+    for (int t = 0; t < hilos; t++) {
+        for (size_t i = 0; i < perdedores[t].size(); i++) delete perdedores[t][i];
+    }
+}
+
+int main(int argc, char** argv) {
+    int hilos = argc > 1 ? atoi(argv[1]) : 8;
+    int idsPorHilo = argc > 2 ? atoi(argv[2]) : 500;
+    int rondas = argc > 3 ? atoi(argv[3]) : 20;
+
+    for (int r = 0; r < rondas; r++) {
+        ronda(hilos, idsPorHilo);
+    }
+
+    if (fallas) {
+        cout << "Prueba de estres: " << fallas << " fallas\n";
+        return 1;
+    }
+    cout << "Prueba de estres OK (" << hilos << " hilos x " << idsPorHilo << " IDs x "
+         << rondas << " rondas)\n";
+    return 0;
+}
@@ -0,0 +1,236 @@
+/**
+ * @file prueba_exportador.cpp
+ * @brief Exporta series a CSV y a binario, las vuelve a leer y verifica que coincidan bit a bit.
+ * @project Sistema IoT de Monitoreo Polimórfico
+ *
+ * Compilar desde la raíz del repositorio:
+ *   g++ -std=c++11 -O2 -I. pruebas/prueba_exportador.cpp -o prueba_exportador
+ */
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <stdint.h>
+
+#include "Exportador.h"
+
+using namespace std;
+
+static int fallas = 0;
+
+/** @brief Registra una falla sin abortar, para reportar todas las del caso. */
+#define VERIFICAR(cond, ...)                         \
+    do {                                             \
+        if (!(cond)) {                               \
+            std::fprintf(stderr, "[FALLA] " __VA_ARGS__); \
+            std::fprintf(stderr, "\n");              \
+            fallas++;                                \
+        }                                            \
+    } while (0)
+
+/** @brief Generador congruencial simple para que la prueba sea reproducible. */
+static unsigned long long semilla = 88172645463325252ULL;
+static uint32_t aleatorio32() {
+    semilla = semilla * 6364136223846793005ULL + 1442695040888963407ULL;
+    return static_cast<uint32_t>(semilla >> 32);
+}
+
+/** @brief Serie leída de vuelta: tipo, ID y los bits de cada valor. */
+struct Serie {
+    char tipo;
+    string id;
+    vector<uint32_t> valores;
+};
+
+static uint32_t bitsDe(float f) {
+    uint32_t b;
+    memcpy(&b, &f, sizeof(b));
+    return b;
+}
+
+static bool leerArchivo(const char* ruta, string& contenido) {
+    FILE* f = fopen(ruta, "rb");
+    if (!f) return false;
+    char bloque[65536];
+    size_t n;
+    while ((n = fread(bloque, 1, sizeof(bloque), f)) > 0) contenido.append(bloque, n);
+    fclose(f);
+    return true;
+}
+
+/**
+ * @brief Interpreta el CSV exportado; los valores se leen con strtof/strtol.
+ * * Las filas consecutivas con el mismo tipo e ID forman una serie.
+ */
+static bool leerCsv(const char* ruta, vector<Serie>& series) {
+    string s;
+    if (!leerArchivo(ruta, s)) return false;
+    const string cabecera = "tipo,id,valor\n";
+    if (s.compare(0, cabecera.size(), cabecera) != 0) return false;
+    size_t i = cabecera.size();
+    while (i < s.size()) {
+        char tipo = s[i++];
+        if (i >= s.size() || s[i++] != ',') return false;
+        string id;
+        if (s[i] == '"') {
+            // Campo entre comillas: "" representa una comilla literal
+            for (i++; ; i++) {
+                if (i >= s.size()) return false;
+                if (s[i] == '"') {
+                    if (i + 1 < s.size() && s[i + 1] == '"') { id += '"'; i++; }
+                    else { i++; break; }
+                } else {
+                    id += s[i];
+                }
+            }
+        } else {
+            while (i < s.size() && s[i] != ',') id += s[i++];
+        }
+        if (i >= s.size() || s[i++] != ',') return false;
+        size_t finLinea = s.find('\n', i);
+        if (finLinea == string::npos) return false;
+        string campo = s.substr(i, finLinea - i);
+        i = finLinea + 1;
+
+        char* fin = nullptr;
+        uint32_t bits;
+        if (tipo == 'T') {
+            float f = strtof(campo.c_str(), &fin);
+            bits = bitsDe(f);
+        } else {
+            long v = strtol(campo.c_str(), &fin, 10);
+            int32_t e = static_cast<int32_t>(v);
+            memcpy(&bits, &e, sizeof(bits));
+        }
+        if (campo.empty() || *fin != '\0') return false;
+
+        if (series.empty() || series.back().tipo != tipo || series.back().id != id) {
+            Serie nueva;
+            nueva.tipo = tipo;
+            nueva.id = id;
+            series.push_back(nueva);
+        }
+        series.back().valores.push_back(bits);
+    }
+    return true;
+}
+
+/** @brief Interpreta el binario exportado ("SIOT" + versión y series columnares). */
+static bool leerBinario(const char* ruta, vector<Serie>& series) {
+    string s;
+    if (!leerArchivo(ruta, s)) return false;
+    if (s.size() < 8 || s.compare(0, 4, "SIOT") != 0) return false;
+    uint32_t version;
+    memcpy(&version, s.data() + 4, sizeof(version));
+    if (version != 1) return false;
+    size_t i = 8;
+    while (i < s.size()) {
+        Serie serie;
+        uint16_t largo;
+        uint64_t cantidad;
+        if (i + 1 + sizeof(largo) > s.size()) return false;
+        serie.tipo = s[i++];
+        memcpy(&largo, s.data() + i, sizeof(largo));
+        i += sizeof(largo);
+        if (i + largo + sizeof(cantidad) > s.size()) return false;
+        serie.id.assign(s.data() + i, largo);
+        i += largo;
+        memcpy(&cantidad, s.data() + i, sizeof(cantidad));
+        i += sizeof(cantidad);
+        if (i + cantidad * 4 > s.size()) return false;
+        serie.valores.resize(static_cast<size_t>(cantidad));
+        for (uint64_t k = 0; k < cantidad; k++, i += 4) memcpy(&serie.valores[k], s.data() + i, 4);
+        series.push_back(serie);
+    }
+    return true;
+}
+
+/** @brief Escribe las series con un formato y reporta si el archivo se completó. */
+static bool exportar(const char* ruta, FormatoExportacion formato,
+                     const ListaSensor<float>& flotantes, const ListaSensor<int>& enteros) {
+    EscritorExportacion escritor(formato);
+    if (!escritor.abrir(ruta)) return false;
+    escritor.serie('T', "T-01", flotantes);
+    escritor.serie('P', "linea \"norte\", sala 2", enteros);
+    escritor.serie('T', "vacio", ListaSensor<float>());
+    return escritor.cerrar();
+}
+
+int main() {
+    ListaSensor<float> flotantes;
+    ListaSensor<int> enteros;
+
+    // Valores de borde: ceros, subnormales, límites y potencias de diez
+    const float especiales[] = {0.0f, -0.0f, 1.0f, -1.0f, 0.1f, 0.3f, 1e-45f, -1e-45f,
+                                1.17549435e-38f, 1.17549421e-38f, 3.40282347e38f, -3.40282347e38f,
+                                1e10f, 1e-10f, 123456789.0f, 16777216.0f, 16777217.0f,
+                                9.999999e-5f, 2.5f, 100.0f, 0.000123f};
+    for (size_t i = 0; i < sizeof(especiales) / sizeof(especiales[0]); i++) {
+        flotantes.insertarFinal(especiales[i]);
+    }
+    flotantes.insertarFinal(INFINITY);
+    flotantes.insertarFinal(-INFINITY);
+    // Lecturas típicas de temperatura con uno o dos decimales
+    for (int i = 0; i < 20000; i++) {
+        flotantes.insertarFinal(static_cast<float>(static_cast<int>(aleatorio32() % 20001) - 5000) / 100.0f);
+    }
+    // Patrones de bits arbitrarios (sin NaN, que no se conserva bit a bit)
+    for (int i = 0; i < 300000; i++) {
+        uint32_t b = aleatorio32();
+        float f;
+        memcpy(&f, &b, sizeof(f));
+        if (std::isnan(f)) continue;
+        flotantes.insertarFinal(f);
+    }
+    const int enterosBorde[] = {0, 1, -1, 2147483647, -2147483647 - 1, 10, 99, 100, -100};
+    for (size_t i = 0; i < sizeof(enterosBorde) / sizeof(enterosBorde[0]); i++) {
+        enteros.insertarFinal(enterosBorde[i]);
+    }
+    for (int i = 0; i < 50000; i++) enteros.insertarFinal(static_cast<int>(aleatorio32()));
+
+    const char* rutaCsv = "prueba_exportador.csv";
+    const char* rutaBin = "prueba_exportador.bin";
+    VERIFICAR(exportar(rutaCsv, EXPORTAR_CSV, flotantes, enteros), "no se pudo escribir %s", rutaCsv);
+    VERIFICAR(exportar(rutaBin, EXPORTAR_BINARIO, flotantes, enteros), "no se pudo escribir %s", rutaBin);
+
+    vector<Serie> csv, bin;
+    VERIFICAR(leerCsv(rutaCsv, csv), "el CSV no se pudo interpretar");
+    VERIFICAR(leerBinario(rutaBin, bin), "el binario no se pudo interpretar");
+
+    // La serie vacía no produce filas en el CSV pero sí una cabecera en el binario
+    VERIFICAR(bin.size() == 3 && bin[2].id == "vacio" && bin[2].valores.empty(),
+              "el binario no conserva la serie vacia");
+    if (bin.size() == 3) bin.pop_back();
+    VERIFICAR(csv.size() == bin.size(), "series: CSV %zu, binario %zu", csv.size(), bin.size());
+    for (size_t k = 0; k < csv.size() && k < bin.size(); k++) {
+        VERIFICAR(csv[k].tipo == bin[k].tipo && csv[k].id == bin[k].id,
+                  "serie %zu: CSV '%c' '%s', binario '%c' '%s'", k, csv[k].tipo, csv[k].id.c_str(),
+                  bin[k].tipo, bin[k].id.c_str());
+        VERIFICAR(csv[k].valores.size() == bin[k].valores.size(), "serie %zu: CSV %zu valores, binario %zu",
+                  k, csv[k].valores.size(), bin[k].valores.size());
+        int distintos = 0;
+        for (size_t i = 0; i < csv[k].valores.size() && i < bin[k].valores.size(); i++) {
+            if (csv[k].valores[i] == bin[k].valores[i]) continue;
+            if (distintos++ < 10) {
+                fprintf(stderr, "serie %zu fila %zu: CSV %08x, binario %08x\n", k, i,
+                        csv[k].valores[i], bin[k].valores[i]);
+            }
+        }
+        VERIFICAR(distintos == 0, "serie %zu: %d valores distintos", k, distintos);
+    }
+    VERIFICAR(!bin.empty() && bin[0].valores.size() == static_cast<size_t>(flotantes.tamano()),
+              "el binario no tiene todas las lecturas");
+
+    remove(rutaCsv);
+    remove(rutaBin);
+    if (fallas) {
+        cout << "Prueba de exportador: " << fallas << " fallas\n";
+        return 1;
+    }
+    cout << "Prueba de exportador OK\n";
+    return 0;
+}
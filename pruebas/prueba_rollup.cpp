@@ -0,0 +1,139 @@
+/**
+ * @file prueba_rollup.cpp
+ * @brief Compara las consultas de HistorialRollup contra un recorrido de las lecturas crudas.
+ * @project Sistema IoT de Monitoreo Polimórfico
+ *
+ * Compilar desde la raíz del repositorio:
+ *   g++ -std=c++11 -O2 -I. pruebas/prueba_rollup.cpp -o prueba_rollup
+ */
+
+#include <iostream>
+#include <vector>
+#include <cstdio>
+
+#include "HistorialRollup.h"
+
+using namespace std;
+
+static int fallas = 0;
+
+/** @brief Registra una falla sin abortar, para reportar todas las del caso. */
+#define VERIFICAR(cond, ...)                         \
+    do {                                             \
+        if (!(cond)) {                               \
+            std::fprintf(stderr, "[FALLA] " __VA_ARGS__); \
+            std::fprintf(stderr, "\n");              \
+            fallas++;                                \
+        }                                            \
+    } while (0)
+
+struct Lectura {
+    long long t;
+    int valor;
+};
+
+/** @brief Generador congruencial simple para que la prueba sea reproducible. */
+static unsigned long long semilla = 88172645463325252ULL;
+static long long aleatorio(long long n) {
+    semilla = semilla * 6364136223846793005ULL + 1442695040888963407ULL;
+    return static_cast<long long>((semilla >> 33) % static_cast<unsigned long long>(n));
+}
+
+/**
+ * @brief Verifica una ventana: el resultado debe coincidir exactamente con las lecturas
+ * crudas desde 'inicioCubierto' hasta el fin del minuto de 'ahora', y el inicio no puede
+ * alejarse del pedido más de una cubeta mientras la ventana quepa en la retención.
+ */
+void verificarVentana(const HistorialRollup<int>& h, const vector<Lectura>& crudas,
+                      long long segundos, long long ahora) {
+    long long cubierto = 0;
+    ResumenLS<int> r = h.consultar(segundos, ahora, &cubierto);
+
+    long long desde = ahora - segundos + 1;
+    VERIFICAR(cubierto >= desde, "ventana %lld: inicio cubierto antes del pedido", segundos);
+    if (ahora == crudas.back().t && segundos <= 86400) {
+        VERIFICAR(cubierto - desde < 60, "ventana %lld: borde de %lld s", segundos, cubierto - desde);
+    } else if (ahora == crudas.back().t && segundos <= 90LL * 86400) {
+        VERIFICAR(cubierto - desde < 3600, "ventana %lld: borde de %lld s", segundos, cubierto - desde);
+    }
+
+    // La cubeta de minuto que contiene 'ahora' se cuenta completa
+    long long fin = ahora - ahora % 60 + 59;
+    ResumenLS<int> esperado;
+    esperado.cuenta = 0;
+    esperado.suma = 0.0;
+    esperado.minimo = 0;
+    esperado.maximo = 0;
+    for (size_t i = 0; i < crudas.size(); i++) {
+        if (crudas[i].t < cubierto || crudas[i].t > fin) continue;
+        int v = crudas[i].valor;
+        if (esperado.cuenta == 0 || v < esperado.minimo) esperado.minimo = v;
+        if (esperado.cuenta == 0 || esperado.maximo < v) esperado.maximo = v;
+        esperado.suma += v;
+        esperado.cuenta++;
+    }
+    VERIFICAR(r.cuenta == esperado.cuenta && r.suma == esperado.suma &&
+              (r.cuenta == 0 || (r.minimo == esperado.minimo && r.maximo == esperado.maximo)),
+              "ventana %lld: cuenta=%lld min=%d max=%d, esperado cuenta=%lld min=%d max=%d",
+              segundos, r.cuenta, r.minimo, r.maximo, esperado.cuenta, esperado.minimo, esperado.maximo);
+}
+
+/** @brief Caso de la revisión: las cubetas parciales del borde no deben contarse. */
+void pruebaBorde() {
+    long long h10 = 1700000000LL - 1700000000LL % 3600;
+    HistorialRollup<int> h;
+    h.registrar(100, h10 + 10);
+    h.registrar(1, h10 + 3599);
+    for (int i = 0; i < 10; i++) h.registrar(50, h10 + 3600 + 58 * 60 + i);
+
+    ResumenLS<int> r = h.consultar(3600, h10 + 2 * 3600 - 1);
+    VERIFICAR(r.cuenta == 10 && r.minimo == 50 && r.maximo == 50,
+              "ventana de 1 h: cuenta=%lld min=%d max=%d", r.cuenta, r.minimo, r.maximo);
+    r = h.consultar(7200, h10 + 2 * 3600 - 1);
+    VERIFICAR(r.cuenta == 12 && r.minimo == 1 && r.maximo == 100,
+              "ventana de 2 h: cuenta=%lld min=%d max=%d", r.cuenta, r.minimo, r.maximo);
+}
+
+/** @brief 120 días de lecturas con huecos aleatorios contra ventanas de 1 s a 120 días. */
+void pruebaAleatoria() {
+    HistorialRollup<int> h;
+    vector<Lectura> crudas;
+    long long t = 1700000000LL;
+    long long fin = t + 120LL * 86400;
+    while (t < fin) {
+        Lectura l;
+        l.t = t;
+        l.valor = static_cast<int>(aleatorio(2001)) - 1000;
+        crudas.push_back(l);
+        h.registrar(l.valor, l.t);
+        // Ráfagas densas alternadas con huecos de hasta varias horas
+        t += aleatorio(10) == 0 ? aleatorio(6 * 3600) : 1 + aleatorio(120);
+    }
+
+    long long ahora = crudas.back().t;
+    long long ventanas[] = {1, 59, 60, 61, 600, 3599, 3600, 3601, 7200 + 17, 23 * 3600,
+                            86400, 86400 + 1, 3 * 86400 + 123, 89LL * 86400, 90LL * 86400,
+                            120LL * 86400};
+    for (size_t i = 0; i < sizeof(ventanas) / sizeof(ventanas[0]); i++) {
+        verificarVentana(h, crudas, ventanas[i], ahora);
+        verificarVentana(h, crudas, ventanas[i], ahora - aleatorio(1800));
+    }
+    for (int i = 0; i < 200; i++) {
+        verificarVentana(h, crudas, 1 + aleatorio(100LL * 86400), ahora - aleatorio(600));
+    }
+
+    long long cubierto = 0;
+    h.consultar(120LL * 86400, ahora, &cubierto);
+    VERIFICAR(cubierto > ahora - 120LL * 86400 + 1, "la ventana de 120 dias no reporta el recorte");
+}
+
+int main() {
+    pruebaBorde();
+    pruebaAleatoria();
+    if (fallas) {
+        cout << "Prueba de rollup: " << fallas << " fallas\n";
+        return 1;
+    }
+    cout << "Prueba de rollup OK\n";
+    return 0;
+}